@@ -314,5 +314,14 @@ void draw(
         intrinsics,
         extrinsics
     );
-    drawMap(screen, texture, height_map, flag_in_world, ball_in_world);
+}
+
+void upscaleImage(Image target, Image source) {
+    for (auto y = 0; y < target.height; ++y) {
+        auto source_y = y * source.height / target.height;
+        for (auto x = 0; x < target.width; ++x) {
+            auto source_x = x * source.width / target.width;
+            target.data[y * target.width + x] = source.data[source_y * source.width + source_x];
+        }
+    }
 }
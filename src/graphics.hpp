@@ -44,3 +44,14 @@ void draw(
     CameraExtrinsics extrinsics,
     StepParameters step_parameters
 );
+
+void drawMap(
+    Image screen,
+    Image texture,
+    Image height_map,
+    Vector4d flag_in_world,
+    Vector4d ball_in_world
+);
+
+// Nearest neighbour scaling of source to fill target.
+void upscaleImage(Image target, Image source);
@@ -10,6 +10,7 @@
 
 #include "camera.hpp"
 #include "graphics.hpp"
+#include "render_budget.hpp"
 
 enum BallState {BALL_MOVING, BALL_STILL};
 
@@ -46,27 +47,6 @@ CameraExtrinsics moveCamera(CameraExtrinsics extrinsics) {
     return translateCamera(extrinsics, x, y, z);
 }
 
-StepParameters getStepParameters() {
-    static auto parameters = StepParameters{};
-    if (isKeyReleased(SDL_SCANCODE_1)) {
-        parameters.step_size *= 1.1;
-        printf("step_size %.4f\n", parameters.step_size);
-    }
-    if (isKeyReleased(SDL_SCANCODE_2)) {
-        parameters.step_size *= 0.9;
-        printf("step_size %.4f\n", parameters.step_size);
-    }
-    if (isKeyReleased(SDL_SCANCODE_3)) {
-        parameters.step_count += 8;
-        printf("step_count %d\n", parameters.step_count);
-    }
-    if (isKeyReleased(SDL_SCANCODE_4)) {
-        parameters.step_count -= 8;
-        printf("step_count %d\n", parameters.step_count);
-    }
-    return parameters;
-}
-
 void printCameraCoordinates(CameraExtrinsics extrinsics) {
     auto forward_in_camera = Vector4d{0, 0, 1, 0};
     auto forward_in_world = (worldFromCamera(extrinsics) * forward_in_camera).eval();
@@ -140,7 +120,11 @@ int main(int, char**) {
     auto HEIGHT = 200;
     auto window = makeFullScreenWindow(WIDTH, HEIGHT, "Voxel Landscape");
     auto screen = makeImage(WIDTH, HEIGHT);
-    auto depth_buffer = makeImaged(WIDTH, HEIGHT);
+    // Allocated at full size and viewed at the current render resolution.
+    auto render_screen = makeImage(WIDTH, HEIGHT);
+    auto render_depth_buffer = makeImaged(WIDTH, HEIGHT);
+    auto render_budget = RenderBudget{};
+    printRenderBudget(render_budget);
     SDL_ShowCursor(SDL_DISABLE);
     auto texture = readPpm("images/texture.ppm");
     auto height_map = readPpm("images/height_map.ppm");
@@ -162,22 +146,40 @@ int main(int, char**) {
         if (hasReceivedQuitEvent() || isKeyDown(SDL_SCANCODE_ESCAPE)) {
             break;
         }
-        auto step_parameters = getStepParameters();
         player = controlPlayer(player);
         player.ball = updateBall(player.ball, height_map);
         player = updateCamera(player);
-        
+
+        auto render_width = renderWidth(render_budget, WIDTH);
+        auto render_height = renderHeight(render_budget, HEIGHT);
+        auto is_full_resolution = render_width == WIDTH && render_height == HEIGHT;
+        auto render_target = is_full_resolution ? screen : render_screen;
+        render_target.width = render_width;
+        render_target.height = render_height;
+        render_depth_buffer.width = render_width;
+        render_depth_buffer.height = render_height;
+        player.intrinsics = makeCameraIntrinsics(render_width, render_height);
+
+        auto render_start = SDL_GetPerformanceCounter();
         draw(
-            screen,
-            depth_buffer,
+            render_target,
+            render_depth_buffer,
             texture,
             height_map,
             flag_in_world,
             player.ball.position_in_world,
             player.intrinsics,
             player.extrinsics,
-            step_parameters
+            render_budget.step_parameters
         );
+        if (!is_full_resolution) {
+            upscaleImage(screen, render_target);
+        }
+        drawMap(screen, texture, height_map, flag_in_world, player.ball.position_in_world);
+        auto render_end = SDL_GetPerformanceCounter();
+        auto render_milliseconds = 1000.0 * (render_end - render_start) / SDL_GetPerformanceFrequency();
+        render_budget = updateRenderBudget(render_budget, render_milliseconds);
+
         drawPixels(window, screen.data);
         presentWindow(window);
     }
@@ -0,0 +1,104 @@
+#include "render_budget.hpp"
+
+#include <stdio.h>
+
+// The step size is derived from the step count so that the furthest
+// marched distance, (step_count - 1)^2 * step_size, stays about the same.
+const auto DEFAULT_STEP_PARAMETERS = StepParameters{};
+const auto MAX_DISTANCE = DEFAULT_STEP_PARAMETERS.step_count * DEFAULT_STEP_PARAMETERS.step_count * DEFAULT_STEP_PARAMETERS.step_size;
+const auto MIN_STEP_COUNT = 64;
+const auto MAX_STEP_COUNT = DEFAULT_STEP_PARAMETERS.step_count;
+const auto STEP_COUNT_INCREMENT = 8;
+const auto MIN_RESOLUTION_EIGHTHS = 4;
+const auto MAX_RESOLUTION_EIGHTHS = 8;
+// Frames averaged before each decision, so that it reflects the current settings.
+const auto WINDOW_FRAMES = 8;
+const auto UPPER_MARGIN = 1.05;
+
+StepParameters makeStepParameters(int step_count) {
+    return StepParameters{
+        .step_count = step_count,
+        .step_size = MAX_DISTANCE / (step_count * step_count),
+    };
+}
+
+RenderBudget decreaseQuality(RenderBudget budget) {
+    if (budget.step_parameters.step_count > MIN_STEP_COUNT) {
+        budget.step_parameters = makeStepParameters(budget.step_parameters.step_count - STEP_COUNT_INCREMENT);
+    }
+    else if (budget.resolution_eighths > MIN_RESOLUTION_EIGHTHS) {
+        budget.resolution_eighths -= 1;
+    }
+    return budget;
+}
+
+RenderBudget increaseQuality(RenderBudget budget) {
+    if (budget.resolution_eighths < MAX_RESOLUTION_EIGHTHS) {
+        budget.resolution_eighths += 1;
+    }
+    else if (budget.step_parameters.step_count < MAX_STEP_COUNT) {
+        budget.step_parameters = makeStepParameters(budget.step_parameters.step_count + STEP_COUNT_INCREMENT);
+    }
+    return budget;
+}
+
+// The ground marches one ray per column, so the render time is assumed to
+// scale with the column count times the step count. Ignoring the fixed cost
+// makes this a slight overestimate.
+double relativeCost(RenderBudget next, RenderBudget current) {
+    auto column_ratio = double(next.resolution_eighths) / current.resolution_eighths;
+    auto step_ratio = double(next.step_parameters.step_count) / current.step_parameters.step_count;
+    return column_ratio * step_ratio;
+}
+
+bool isSameQuality(RenderBudget a, RenderBudget b) {
+    return a.resolution_eighths == b.resolution_eighths &&
+        a.step_parameters.step_count == b.step_parameters.step_count;
+}
+
+RenderBudget updateRenderBudget(RenderBudget budget, double render_milliseconds) {
+    budget.window_milliseconds += render_milliseconds;
+    budget.window_frames += 1;
+    if (budget.window_frames < WINDOW_FRAMES) {
+        return budget;
+    }
+    auto mean_milliseconds = budget.window_milliseconds / budget.window_frames;
+    budget.window_milliseconds = 0.0;
+    budget.window_frames = 0;
+
+    auto previous = budget;
+    auto max_milliseconds = UPPER_MARGIN * budget.target_milliseconds;
+    if (mean_milliseconds > max_milliseconds) {
+        budget = decreaseQuality(budget);
+    }
+    else {
+        auto increased = increaseQuality(budget);
+        // Upgrade only below the target, so noise cannot push it over max_milliseconds.
+        if (mean_milliseconds * relativeCost(increased, budget) < budget.target_milliseconds) {
+            budget = increased;
+        }
+    }
+    if (!isSameQuality(budget, previous)) {
+        printf("render %.2f ms ", mean_milliseconds);
+        printRenderBudget(budget);
+    }
+    return budget;
+}
+
+void printRenderBudget(RenderBudget budget) {
+    printf(
+        "target %.2f ms: resolution %d/8 step_count %d step_size %.4f\n",
+        budget.target_milliseconds,
+        budget.resolution_eighths,
+        budget.step_parameters.step_count,
+        budget.step_parameters.step_size
+    );
+}
+
+int renderWidth(RenderBudget budget, int output_width) {
+    return output_width * budget.resolution_eighths / 8;
+}
+
+int renderHeight(RenderBudget budget, int output_height) {
+    return output_height * budget.resolution_eighths / 8;
+}
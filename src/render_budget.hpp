@@ -0,0 +1,23 @@
+#pragma once
+
+#include "graphics.hpp"
+
+// Adapts the ray marching steps and the internal render resolution
+// to keep the measured render time close to a target. The target is a
+// budget for drawing and upscaling only, not the full frame time, so that
+// waiting for vsync in presentWindow is not counted.
+
+struct RenderBudget {
+    double target_milliseconds = 8.3;
+    double window_milliseconds = 0.0;
+    int window_frames = 0;
+    int resolution_eighths = 8;
+    StepParameters step_parameters;
+};
+
+RenderBudget updateRenderBudget(RenderBudget budget, double render_milliseconds);
+
+void printRenderBudget(RenderBudget budget);
+
+int renderWidth(RenderBudget budget, int output_width);
+int renderHeight(RenderBudget budget, int output_height);